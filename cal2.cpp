@@ -4,13 +4,23 @@
 #include <ctime>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <sstream>
 #include <fstream>
 #include <array>
 #include <cstdlib>
+#include <cstdio>
 #include <algorithm>
 #include <map>
+#include <unordered_map>
+#include <cctype>
 #include <filesystem>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <future>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -21,11 +31,13 @@
 #undef min
 #endif
 #include <direct.h>
+#include <conio.h>
 #define LOCALTIME(t, result) *(result) = *localtime((t))
 #define HOME_ENV "USERPROFILE"
 #else
 #include <unistd.h>
 #include <pwd.h>
+#include <termios.h>
 #define LOCALTIME(t, result) localtime_r((t), (result))
 #define HOME_ENV "HOME"
 #endif
@@ -40,6 +52,7 @@ constexpr char YELLOW[] = "\033[33m";
 constexpr char MAGENTA[] = "\033[35m";
 constexpr char CYAN[] = "\033[36m";
 constexpr char REV[]   = "\033[7m";
+constexpr char UNDERLINE[] = "\033[4m";
 constexpr char BLACK[] = "\033[30m";
 constexpr char WHITE[] = "\033[37m";
 constexpr char BRIGHT_RED[] = "\033[91m";
@@ -58,6 +71,7 @@ constexpr char YELLOW[] = "\x1b[33m";
 constexpr char MAGENTA[] = "\x1b[35m";
 constexpr char CYAN[] = "\x1b[36m";
 constexpr char REV[]   = "\x1b[7m";
+constexpr char UNDERLINE[] = "\x1b[4m";
 constexpr char BLACK[] = "\x1b[30m";
 constexpr char WHITE[] = "\x1b[37m";
 constexpr char BRIGHT_RED[] = "\x1b[91m";
@@ -69,54 +83,307 @@ constexpr char BRIGHT_CYAN[] = "\x1b[96m";
 constexpr char BRIGHT_WHITE[] = "\x1b[97m";
 #endif
 
+// Palette index into COLOR_TABLE; index 0 is the terminal default color
+using ColorIndex = uint8_t;
+
+struct NamedColor {
+    std::string_view name;
+    std::string_view escape;
+};
+
+// Single escape table shared by every color in the config. Names resolve to an
+// index once at load time, so rendering only appends views into this table.
+constexpr NamedColor COLOR_TABLE[] = {
+    {"default", ""},
+    {"none", ""},
+    // Basic colors
+    {"red", RED},
+    {"blue", BLUE},
+    {"green", GREEN},
+    {"yellow", YELLOW},
+    {"magenta", MAGENTA},
+    {"cyan", CYAN},
+    {"black", BLACK},
+    {"white", WHITE},
+    // Bright colors
+    {"bright_red", BRIGHT_RED},
+    {"bright_green", BRIGHT_GREEN},
+    {"bright_yellow", BRIGHT_YELLOW},
+    {"bright_blue", BRIGHT_BLUE},
+    {"bright_magenta", BRIGHT_MAGENTA},
+    {"bright_cyan", BRIGHT_CYAN},
+    {"bright_white", BRIGHT_WHITE},
+    // 256-color support (common colors)
+    {"orange", "\033[38;5;208m"},
+    {"purple", "\033[38;5;129m"},
+    {"pink", "\033[38;5;205m"},
+    {"brown", "\033[38;5;130m"},
+    {"gray", "\033[38;5;244m"},
+    {"grey", "\033[38;5;244m"},
+    {"dark_red", "\033[38;5;88m"},
+    {"dark_green", "\033[38;5;22m"},
+    {"dark_blue", "\033[38;5;18m"},
+    {"light_red", "\033[38;5;203m"},
+    {"light_green", "\033[38;5;119m"},
+    {"light_blue", "\033[38;5;117m"},
+    {"gold", "\033[38;5;220m"},
+    {"silver", "\033[38;5;250m"},
+    {"lime", "\033[38;5;154m"},
+    {"navy", "\033[38;5;17m"},
+    {"maroon", "\033[38;5;52m"},
+    {"olive", "\033[38;5;58m"},
+    {"teal", "\033[38;5;30m"},
+    {"aqua", "\033[38;5;51m"},
+    {"fuchsia", "\033[38;5;201m"},
+    // Colors optimized for light backgrounds
+    {"dark_gray", "\033[38;5;236m"},
+    {"dark_grey", "\033[38;5;236m"},
+    {"charcoal", "\033[38;5;238m"},
+    {"slate", "\033[38;5;240m"},
+    {"steel", "\033[38;5;67m"},
+    {"indigo", "\033[38;5;54m"},
+    {"violet", "\033[38;5;93m"},
+    {"crimson", "\033[38;5;160m"},
+    {"forest", "\033[38;5;28m"},
+    {"emerald", "\033[38;5;34m"},
+    {"sapphire", "\033[38;5;19m"},
+    {"amber", "\033[38;5;214m"},
+    {"coral", "\033[38;5;209m"},
+    {"rust", "\033[38;5;166m"},
+    {"bronze", "\033[38;5;136m"},
+    {"copper", "\033[38;5;173m"},
+    {"chocolate", "\033[38;5;94m"},
+    {"coffee", "\033[38;5;52m"},
+    {"wine", "\033[38;5;89m"},
+    {"plum", "\033[38;5;96m"},
+    {"midnight", "\033[38;5;17m"},
+    {"deep_blue", "\033[38;5;20m"},
+    {"deep_green", "\033[38;5;22m"},
+    {"deep_red", "\033[38;5;88m"},
+    {"deep_purple", "\033[38;5;55m"},
+    {"deep_orange", "\033[38;5;130m"},
+    {"royal_blue", "\033[38;5;21m"},
+    {"royal_purple", "\033[38;5;57m"},
+    {"sea_green", "\033[38;5;29m"},
+    {"sky_blue", "\033[38;5;75m"},
+    {"rose", "\033[38;5;168m"},
+    {"salmon", "\033[38;5;174m"},
+    {"peach", "\033[38;5;216m"},
+    {"mint", "\033[38;5;121m"},
+    {"lavender", "\033[38;5;183m"},
+    {"turquoise", "\033[38;5;80m"},
+};
+
+constexpr size_t COLOR_COUNT = sizeof(COLOR_TABLE) / sizeof(COLOR_TABLE[0]);
+static_assert(COLOR_COUNT <= 256, "ColorIndex must be able to address every palette entry");
+
+// Look up a lower-case color name; unknown names map to the default color
+constexpr ColorIndex color_index(std::string_view name) {
+    for (size_t i = 0; i < COLOR_COUNT; ++i) {
+        if (COLOR_TABLE[i].name == name) return static_cast<ColorIndex>(i);
+    }
+    return 0;
+}
+
+// Escapes for #RRGGBB colors, resolved while the config loads. They take the
+// palette indices after COLOR_TABLE and must not change once rendering starts.
+std::vector<std::string> custom_escapes;
+
+inline std::string_view color_escape(ColorIndex index) {
+    if (index < COLOR_COUNT) return COLOR_TABLE[index].escape;
+    return custom_escapes[index - COLOR_COUNT];
+}
+
+// Color depth the terminal is assumed to support for #RRGGBB colors
+enum class ColorDepth {
+    BASIC16,
+    COLOR256,
+    TRUECOLOR
+};
+
+struct Rgb {
+    int r, g, b;
+};
+
+constexpr int color_distance(Rgb a, Rgb b) {
+    return (a.r - b.r) * (a.r - b.r) + (a.g - b.g) * (a.g - b.g) + (a.b - b.b) * (a.b - b.b);
+}
+
+// xterm defaults for the 16 basic colors (30-37, then bright 90-97)
+constexpr Rgb BASIC16_RGB[16] = {
+    {0, 0, 0}, {205, 0, 0}, {0, 205, 0}, {205, 205, 0},
+    {0, 0, 238}, {205, 0, 205}, {0, 205, 205}, {229, 229, 229},
+    {127, 127, 127}, {255, 0, 0}, {0, 255, 0}, {255, 255, 0},
+    {92, 92, 255}, {255, 0, 255}, {0, 255, 255}, {255, 255, 255}
+};
+
+// Channel levels of the 6x6x6 cube in the 256-color palette (indices 16-231)
+constexpr int CUBE_LEVELS[6] = {0, 95, 135, 175, 215, 255};
+
+// Nearest cube level for every channel value
+constexpr std::array<uint8_t, 256> make_cube_level_lut() {
+    std::array<uint8_t, 256> lut{};
+    for (int v = 0; v < 256; ++v) {
+        int best = 0;
+        for (int i = 1; i < 6; ++i) {
+            int diff = CUBE_LEVELS[i] - v, best_diff = CUBE_LEVELS[best] - v;
+            if (diff * diff < best_diff * best_diff) best = i;
+        }
+        lut[v] = static_cast<uint8_t>(best);
+    }
+    return lut;
+}
+
+// Nearest step of the 24-step gray ramp (indices 232-255, 8 + 10 * i)
+constexpr std::array<uint8_t, 256> make_gray_lut() {
+    std::array<uint8_t, 256> lut{};
+    for (int v = 0; v < 256; ++v) {
+        int step = (v - 3) / 10;
+        lut[v] = static_cast<uint8_t>(step < 0 ? 0 : (step > 23 ? 23 : step));
+    }
+    return lut;
+}
+
+// 16x16x16 cube mapping the top 4 bits of each channel to the nearest basic color
+constexpr std::array<uint8_t, 16 * 16 * 16> make_basic16_cube() {
+    std::array<uint8_t, 16 * 16 * 16> cube{};
+    for (int r = 0; r < 16; ++r) {
+        for (int g = 0; g < 16; ++g) {
+            for (int b = 0; b < 16; ++b) {
+                Rgb c = {r * 17, g * 17, b * 17};
+                int best = 0;
+                for (int i = 1; i < 16; ++i) {
+                    if (color_distance(c, BASIC16_RGB[i]) < color_distance(c, BASIC16_RGB[best])) best = i;
+                }
+                cube[(r << 8) | (g << 4) | b] = static_cast<uint8_t>(best);
+            }
+        }
+    }
+    return cube;
+}
+
+constexpr auto CUBE_LEVEL_LUT = make_cube_level_lut();
+constexpr auto GRAY_LUT = make_gray_lut();
+constexpr auto BASIC16_CUBE = make_basic16_cube();
+
+// Nearest 256-color index: the closer of the cube and gray ramp candidates
+constexpr int nearest_color256(Rgb c) {
+    int ri = CUBE_LEVEL_LUT[c.r], gi = CUBE_LEVEL_LUT[c.g], bi = CUBE_LEVEL_LUT[c.b];
+    Rgb cube = {CUBE_LEVELS[ri], CUBE_LEVELS[gi], CUBE_LEVELS[bi]};
+    int gray_step = GRAY_LUT[(c.r + c.g + c.b) / 3];
+    int level = 8 + 10 * gray_step;
+    Rgb gray = {level, level, level};
+    if (color_distance(c, gray) < color_distance(c, cube)) return 232 + gray_step;
+    return 16 + 36 * ri + 6 * gi + bi;
+}
+
+constexpr int nearest_basic16(Rgb c) {
+    return BASIC16_CUBE[((c.r >> 4) << 8) | ((c.g >> 4) << 4) | (c.b >> 4)];
+}
+
+ColorDepth detect_color_depth() {
+    const char* colorterm = std::getenv("COLORTERM");
+    if (colorterm) {
+        std::string value = colorterm;
+        if (value == "truecolor" || value == "24bit") return ColorDepth::TRUECOLOR;
+    }
+#ifdef _WIN32
+    // Windows Terminal supports 24-bit color but does not set COLORTERM
+    if (std::getenv("WT_SESSION")) return ColorDepth::TRUECOLOR;
+#endif
+    const char* term = std::getenv("TERM");
+    if (!term || !*term) return ColorDepth::COLOR256;  // Consoles without TERM, as for the named colors
+    std::string value = term;
+    if (value.find("direct") != std::string::npos) return ColorDepth::TRUECOLOR;  // xterm-direct and friends
+    if (value.find("256") != std::string::npos) return ColorDepth::COLOR256;
+    return ColorDepth::BASIC16;
+}
+
+// Parse "#RRGGBB"; returns false for anything else
+bool parse_hex_color(const std::string& value, Rgb& rgb) {
+    if (value.size() != 7 || value[0] != '#') return false;
+    int channels[3];
+    for (int i = 0; i < 3; ++i) {
+        int channel = 0;
+        for (int j = 1 + 2 * i; j < 3 + 2 * i; ++j) {
+            char ch = value[j];
+            int digit;
+            if (ch >= '0' && ch <= '9') digit = ch - '0';
+            else if (ch >= 'a' && ch <= 'f') digit = ch - 'a' + 10;
+            else if (ch >= 'A' && ch <= 'F') digit = ch - 'A' + 10;
+            else return false;
+            channel = channel * 16 + digit;
+        }
+        channels[i] = channel;
+    }
+    rgb = {channels[0], channels[1], channels[2]};
+    return true;
+}
+
+// Build the escape for an RGB color at the terminal's color depth
+std::string rgb_escape(Rgb rgb, ColorDepth depth) {
+    switch (depth) {
+        case ColorDepth::TRUECOLOR:
+            return "\033[38;2;" + std::to_string(rgb.r) + ";" + std::to_string(rgb.g) + ";" +
+                   std::to_string(rgb.b) + "m";
+        case ColorDepth::COLOR256:
+            return "\033[38;5;" + std::to_string(nearest_color256(rgb)) + "m";
+        default: {
+            int index = nearest_basic16(rgb);
+            return "\033[" + std::to_string(index < 8 ? 30 + index : 90 + index - 8) + "m";
+        }
+    }
+}
+
+// Add an escape to the custom palette, sharing entries between identical colors
+ColorIndex add_custom_escape(const std::string& escape) {
+    for (size_t i = 0; i < custom_escapes.size(); ++i) {
+        if (custom_escapes[i] == escape) return static_cast<ColorIndex>(COLOR_COUNT + i);
+    }
+    if (COLOR_COUNT + custom_escapes.size() > 255) {
+        std::cerr << "Warning: too many custom colors, using default color\n";
+        return 0;
+    }
+    custom_escapes.push_back(escape);
+    return static_cast<ColorIndex>(COLOR_COUNT + custom_escapes.size() - 1);
+}
+
 // Color configuration structure
 struct ColorConfig {
 #ifdef _WIN32
-    std::string sunday_title = BRIGHT_RED;
-    std::string saturday_title = BRIGHT_BLUE;
-    std::string workday_title = "";
-    std::string sunday_date = BRIGHT_RED;
-    std::string saturday_date = BRIGHT_BLUE;
-    std::string workday_date = "";
-    std::string holiday = BRIGHT_RED;
-    std::string birthday = BRIGHT_MAGENTA;
-    std::string reminder = BRIGHT_CYAN;
-    // Month colors - colorful defaults
-    std::string january = BRIGHT_CYAN;
-    std::string february = BRIGHT_MAGENTA;
-    std::string march = BRIGHT_GREEN;
-    std::string april = BRIGHT_YELLOW;
-    std::string may = BRIGHT_RED;
-    std::string june = BRIGHT_BLUE;
-    std::string july = BRIGHT_YELLOW;
-    std::string august = BRIGHT_GREEN;
-    std::string september = BRIGHT_MAGENTA;
-    std::string october = BRIGHT_RED;
-    std::string november = BRIGHT_CYAN;
-    std::string december = BRIGHT_BLUE;
+    ColorIndex sunday_title = color_index("bright_red");
+    ColorIndex saturday_title = color_index("bright_blue");
+    ColorIndex workday_title = color_index("default");
+    ColorIndex sunday_date = color_index("bright_red");
+    ColorIndex saturday_date = color_index("bright_blue");
+    ColorIndex workday_date = color_index("default");
+    ColorIndex holiday = color_index("bright_red");
+    ColorIndex birthday = color_index("bright_magenta");
+    ColorIndex reminder = color_index("bright_cyan");
+    // Month colors - colorful defaults, January first
+    std::array<ColorIndex, 12> months = {
+        color_index("bright_cyan"), color_index("bright_magenta"), color_index("bright_green"),
+        color_index("bright_yellow"), color_index("bright_red"), color_index("bright_blue"),
+        color_index("bright_yellow"), color_index("bright_green"), color_index("bright_magenta"),
+        color_index("bright_red"), color_index("bright_cyan"), color_index("bright_blue")
+    };
 #else
-    std::string sunday_title = RED;
-    std::string saturday_title = BLUE;
-    std::string workday_title = "";
-    std::string sunday_date = RED;
-    std::string saturday_date = BLUE;
-    std::string workday_date = "";
-    std::string holiday = RED;
-    std::string birthday = MAGENTA;
-    std::string reminder = CYAN;
-    // Month colors - colorful defaults
-    std::string january = CYAN;
-    std::string february = MAGENTA;
-    std::string march = GREEN;
-    std::string april = YELLOW;
-    std::string may = RED;
-    std::string june = BLUE;
-    std::string july = YELLOW;
-    std::string august = GREEN;
-    std::string september = MAGENTA;
-    std::string october = RED;
-    std::string november = CYAN;
-    std::string december = BLUE;
+    ColorIndex sunday_title = color_index("red");
+    ColorIndex saturday_title = color_index("blue");
+    ColorIndex workday_title = color_index("default");
+    ColorIndex sunday_date = color_index("red");
+    ColorIndex saturday_date = color_index("blue");
+    ColorIndex workday_date = color_index("default");
+    ColorIndex holiday = color_index("red");
+    ColorIndex birthday = color_index("magenta");
+    ColorIndex reminder = color_index("cyan");
+    // Month colors - colorful defaults, January first
+    std::array<ColorIndex, 12> months = {
+        color_index("cyan"), color_index("magenta"), color_index("green"),
+        color_index("yellow"), color_index("red"), color_index("blue"),
+        color_index("yellow"), color_index("green"), color_index("magenta"),
+        color_index("red"), color_index("cyan"), color_index("blue")
+    };
 #endif
 };
 
@@ -141,94 +408,35 @@ struct Event {
 // Global events map: key = "MM-DD", value = vector of events
 std::map<std::string, std::vector<Event>> events;
 
-// Function to convert color name to ANSI code
-std::string get_color_code(const std::string& color_name) {
+// Multi-day event: MM/DD-MM/DD repeats every year (and may wrap past New Year),
+// YYYY/MM/DD-YYYY/MM/DD covers one dated range
+struct EventSpan {
+    int start_year;  // 0 for spans that repeat every year
+    int start_month;
+    int start_day;
+    int end_year;
+    int end_month;
+    int end_day;
+    std::string description;
+    EventType type;
+};
+
+std::vector<EventSpan> spans;
+
+// Resolve a color name from the config to its palette index
+ColorIndex get_color_index(const std::string& color_name) {
     std::string lower_name = color_name;
     std::transform(lower_name.begin(), lower_name.end(), lower_name.begin(), ::tolower);
 
-    // Basic colors
-    if (lower_name == "red") return RED;
-    if (lower_name == "blue") return BLUE;
-    if (lower_name == "green") return GREEN;
-    if (lower_name == "yellow") return YELLOW;
-    if (lower_name == "magenta") return MAGENTA;
-    if (lower_name == "cyan") return CYAN;
-    if (lower_name == "black") return BLACK;
-    if (lower_name == "white") return WHITE;
-    
-    // Bright colors
-    if (lower_name == "bright_red") return BRIGHT_RED;
-    if (lower_name == "bright_green") return BRIGHT_GREEN;
-    if (lower_name == "bright_yellow") return BRIGHT_YELLOW;
-    if (lower_name == "bright_blue") return BRIGHT_BLUE;
-    if (lower_name == "bright_magenta") return BRIGHT_MAGENTA;
-    if (lower_name == "bright_cyan") return BRIGHT_CYAN;
-    if (lower_name == "bright_white") return BRIGHT_WHITE;
-    
-    // 256-color support (common colors)
-    if (lower_name == "orange") return "\033[38;5;208m";
-    if (lower_name == "purple") return "\033[38;5;129m";
-    if (lower_name == "pink") return "\033[38;5;205m";
-    if (lower_name == "brown") return "\033[38;5;130m";
-    if (lower_name == "gray" || lower_name == "grey") return "\033[38;5;244m";
-    if (lower_name == "dark_red") return "\033[38;5;88m";
-    if (lower_name == "dark_green") return "\033[38;5;22m";
-    if (lower_name == "dark_blue") return "\033[38;5;18m";
-    if (lower_name == "light_red") return "\033[38;5;203m";
-    if (lower_name == "light_green") return "\033[38;5;119m";
-    if (lower_name == "light_blue") return "\033[38;5;117m";
-    if (lower_name == "gold") return "\033[38;5;220m";
-    if (lower_name == "silver") return "\033[38;5;250m";
-    if (lower_name == "lime") return "\033[38;5;154m";
-    if (lower_name == "navy") return "\033[38;5;17m";
-    if (lower_name == "maroon") return "\033[38;5;52m";
-    if (lower_name == "olive") return "\033[38;5;58m";
-    if (lower_name == "teal") return "\033[38;5;30m";
-    if (lower_name == "aqua") return "\033[38;5;51m";
-    if (lower_name == "fuchsia") return "\033[38;5;201m";
-    
-    // Colors optimized for light backgrounds
-    if (lower_name == "dark_gray" || lower_name == "dark_grey") return "\033[38;5;236m";
-    if (lower_name == "charcoal") return "\033[38;5;238m";
-    if (lower_name == "slate") return "\033[38;5;240m";
-    if (lower_name == "steel") return "\033[38;5;67m";
-    if (lower_name == "indigo") return "\033[38;5;54m";
-    if (lower_name == "violet") return "\033[38;5;93m";
-    if (lower_name == "crimson") return "\033[38;5;160m";
-    if (lower_name == "forest") return "\033[38;5;28m";
-    if (lower_name == "emerald") return "\033[38;5;34m";
-    if (lower_name == "sapphire") return "\033[38;5;19m";
-    if (lower_name == "amber") return "\033[38;5;214m";
-    if (lower_name == "coral") return "\033[38;5;209m";
-    if (lower_name == "rust") return "\033[38;5;166m";
-    if (lower_name == "bronze") return "\033[38;5;136m";
-    if (lower_name == "copper") return "\033[38;5;173m";
-    if (lower_name == "chocolate") return "\033[38;5;94m";
-    if (lower_name == "coffee") return "\033[38;5;52m";
-    if (lower_name == "wine") return "\033[38;5;89m";
-    if (lower_name == "plum") return "\033[38;5;96m";
-    if (lower_name == "midnight") return "\033[38;5;17m";
-    if (lower_name == "deep_blue") return "\033[38;5;20m";
-    if (lower_name == "deep_green") return "\033[38;5;22m";
-    if (lower_name == "deep_red") return "\033[38;5;88m";
-    if (lower_name == "deep_purple") return "\033[38;5;55m";
-    if (lower_name == "deep_orange") return "\033[38;5;130m";
-    if (lower_name == "royal_blue") return "\033[38;5;21m";
-    if (lower_name == "royal_purple") return "\033[38;5;57m";
-    if (lower_name == "sea_green") return "\033[38;5;29m";
-    if (lower_name == "sky_blue") return "\033[38;5;75m";
-    if (lower_name == "rose") return "\033[38;5;168m";
-    if (lower_name == "salmon") return "\033[38;5;174m";
-    if (lower_name == "peach") return "\033[38;5;216m";
-    if (lower_name == "mint") return "\033[38;5;121m";
-    if (lower_name == "lavender") return "\033[38;5;183m";
-    if (lower_name == "turquoise") return "\033[38;5;80m";
-    
-    // Default/none
-    if (lower_name == "none" || lower_name == "default" || lower_name == "") return "";
+    // #RRGGBB is resolved to an escape for this terminal once, here
+    Rgb rgb;
+    if (parse_hex_color(lower_name, rgb)) {
+        static const ColorDepth depth = detect_color_depth();
+        return add_custom_escape(rgb_escape(rgb, depth));
+    }
 
-    // If color name not recognized, return empty string (default color)
-    return "";
+    // If color name not recognized, the default color is used
+    return color_index(lower_name);
 }
 
 std::string get_home_dir() {
@@ -280,6 +488,63 @@ void parse_date(const std::string& date_str, int& month, int& day) {
     }
 }
 
+// Parse MM/DD or YYYY/MM/DD; year is 0 when omitted
+bool parse_span_date(const std::string& date_str, int& year, int& month, int& day) {
+    year = 0;
+    size_t slashes = std::count(date_str.begin(), date_str.end(), '/');
+    if (slashes == 1) {
+        parse_date(date_str, month, day);
+    } else if (slashes == 2) {
+        char sep1 = 0, sep2 = 0;
+        std::istringstream iss(date_str);
+        if (!(iss >> year >> sep1 >> month >> sep2 >> day)) return false;
+    } else {
+        return false;
+    }
+    return month >= 1 && month <= 12 && day >= 1 && day <= 31;
+}
+
+// Parse a "START-END" range; both ends must use the same form
+bool parse_span(const std::string& date_str, EventSpan& span) {
+    size_t dash = date_str.find('-');
+    if (dash == std::string::npos) return false;
+    if (!parse_span_date(date_str.substr(0, dash), span.start_year, span.start_month, span.start_day) ||
+        !parse_span_date(date_str.substr(dash + 1), span.end_year, span.end_month, span.end_day)) {
+        return false;
+    }
+    if ((span.start_year == 0) != (span.end_year == 0)) return false;
+    if (span.start_year != 0) {
+        // Dated ranges must not run backwards
+        int start = span.start_year * 10000 + span.start_month * 100 + span.start_day;
+        int end = span.end_year * 10000 + span.end_month * 100 + span.end_day;
+        if (start > end) return false;
+    }
+    return true;
+}
+
+// Event type from its section, or from keywords in the description outside known sections
+EventType classify_event(const std::string& section, const std::string& description) {
+    if (section == "holidays" || section == "holiday") {
+        return EventType::HOLIDAY;
+    } else if (section == "birthdays" || section == "birthday") {
+        return EventType::BIRTHDAY;
+    } else if (section == "reminders" || section == "reminder") {
+        return EventType::REMINDER;
+    }
+
+    // Auto-detect based on description
+    if (description.find("birthday") != std::string::npos ||
+        description.find("Birthday") != std::string::npos ||
+        description.find("BIRTHDAY") != std::string::npos) {
+        return EventType::BIRTHDAY;
+    } else if (description.find("holiday") != std::string::npos ||
+               description.find("Holiday") != std::string::npos ||
+               description.find("HOLIDAY") != std::string::npos) {
+        return EventType::HOLIDAY;
+    }
+    return EventType::REMINDER;
+}
+
 void load_events() {
     std::string config_path = get_config_path();
     if (config_path.empty()) {
@@ -355,28 +620,28 @@ void load_events() {
 
                 std::transform(key.begin(), key.end(), key.begin(), ::tolower);
 
-                if (key == "sunday_title") colors.sunday_title = get_color_code(value);
-                else if (key == "saturday_title") colors.saturday_title = get_color_code(value);
-                else if (key == "workday_title") colors.workday_title = get_color_code(value);
-                else if (key == "sunday_date") colors.sunday_date = get_color_code(value);
-                else if (key == "saturday_date") colors.saturday_date = get_color_code(value);
-                else if (key == "workday_date") colors.workday_date = get_color_code(value);
-                else if (key == "holiday") colors.holiday = get_color_code(value);
-                else if (key == "birthday") colors.birthday = get_color_code(value);
-                else if (key == "reminder") colors.reminder = get_color_code(value);
+                if (key == "sunday_title") colors.sunday_title = get_color_index(value);
+                else if (key == "saturday_title") colors.saturday_title = get_color_index(value);
+                else if (key == "workday_title") colors.workday_title = get_color_index(value);
+                else if (key == "sunday_date") colors.sunday_date = get_color_index(value);
+                else if (key == "saturday_date") colors.saturday_date = get_color_index(value);
+                else if (key == "workday_date") colors.workday_date = get_color_index(value);
+                else if (key == "holiday") colors.holiday = get_color_index(value);
+                else if (key == "birthday") colors.birthday = get_color_index(value);
+                else if (key == "reminder") colors.reminder = get_color_index(value);
                 // Month colors
-                else if (key == "january" || key == "jan" || key == "1") colors.january = get_color_code(value);
-                else if (key == "february" || key == "feb" || key == "2") colors.february = get_color_code(value);
-                else if (key == "march" || key == "mar" || key == "3") colors.march = get_color_code(value);
-                else if (key == "april" || key == "apr" || key == "4") colors.april = get_color_code(value);
-                else if (key == "may" || key == "5") colors.may = get_color_code(value);
-                else if (key == "june" || key == "jun" || key == "6") colors.june = get_color_code(value);
-                else if (key == "july" || key == "jul" || key == "7") colors.july = get_color_code(value);
-                else if (key == "august" || key == "aug" || key == "8") colors.august = get_color_code(value);
-                else if (key == "september" || key == "sep" || key == "9") colors.september = get_color_code(value);
-                else if (key == "october" || key == "oct" || key == "10") colors.october = get_color_code(value);
-                else if (key == "november" || key == "nov" || key == "11") colors.november = get_color_code(value);
-                else if (key == "december" || key == "dec" || key == "12") colors.december = get_color_code(value);
+                else if (key == "january" || key == "jan" || key == "1") colors.months[0] = get_color_index(value);
+                else if (key == "february" || key == "feb" || key == "2") colors.months[1] = get_color_index(value);
+                else if (key == "march" || key == "mar" || key == "3") colors.months[2] = get_color_index(value);
+                else if (key == "april" || key == "apr" || key == "4") colors.months[3] = get_color_index(value);
+                else if (key == "may" || key == "5") colors.months[4] = get_color_index(value);
+                else if (key == "june" || key == "jun" || key == "6") colors.months[5] = get_color_index(value);
+                else if (key == "july" || key == "jul" || key == "7") colors.months[6] = get_color_index(value);
+                else if (key == "august" || key == "aug" || key == "8") colors.months[7] = get_color_index(value);
+                else if (key == "september" || key == "sep" || key == "9") colors.months[8] = get_color_index(value);
+                else if (key == "october" || key == "oct" || key == "10") colors.months[9] = get_color_index(value);
+                else if (key == "november" || key == "nov" || key == "11") colors.months[10] = get_color_index(value);
+                else if (key == "december" || key == "dec" || key == "12") colors.months[11] = get_color_index(value);
             }
             continue;
         }
@@ -392,6 +657,20 @@ void load_events() {
                 description = description.substr(1); // Remove leading space
             }
 
+            // Ranges such as 12/24-1/2 or 2025/07/01-2025/07/14
+            if (date_str.find('/') != std::string::npos && date_str.find('-') != std::string::npos) {
+                EventSpan span;
+                if (parse_span(date_str, span)) {
+                    span.description = description;
+                    span.type = classify_event(current_section, description);
+                    spans.push_back(span);
+                    events_loaded++;
+                } else {
+                    std::cerr << "Invalid date range: " << date_str << std::endl;
+                }
+                continue;
+            }
+
             int month = 0, day = 0;
             parse_date(date_str, month, day);
 
@@ -400,28 +679,7 @@ void load_events() {
                 event.month = month;
                 event.day = day;
                 event.description = description;
-
-                // Determine event type based on section or description
-                if (current_section == "holidays" || current_section == "holiday") {
-                    event.type = EventType::HOLIDAY;
-                } else if (current_section == "birthdays" || current_section == "birthday") {
-                    event.type = EventType::BIRTHDAY;
-                } else if (current_section == "reminders" || current_section == "reminder") {
-                    event.type = EventType::REMINDER;
-                } else {
-                    // Auto-detect based on description
-                    if (description.find("birthday") != std::string::npos ||
-                        description.find("Birthday") != std::string::npos ||
-                        description.find("BIRTHDAY") != std::string::npos) {
-                        event.type = EventType::BIRTHDAY;
-                    } else if (description.find("holiday") != std::string::npos ||
-                              description.find("Holiday") != std::string::npos ||
-                              description.find("HOLIDAY") != std::string::npos) {
-                        event.type = EventType::HOLIDAY;
-                    } else {
-                        event.type = EventType::REMINDER;
-                    }
-                }
+                event.type = classify_event(current_section, description);
 
                 std::string key = std::to_string(month) + "-" + std::to_string(day);
                 events[key].push_back(event);
@@ -435,42 +693,30 @@ void load_events() {
     // std::cerr << "Total events loaded: " << events_loaded << std::endl;
 }
 
-std::string get_event_color(const Event& event) {
-    switch (event.type) {
-        case EventType::HOLIDAY: return colors.holiday;
-        case EventType::BIRTHDAY: return colors.birthday;
-        case EventType::REMINDER: return colors.reminder;
+std::string_view get_type_color(EventType type) {
+    switch (type) {
+        case EventType::HOLIDAY: return color_escape(colors.holiday);
+        case EventType::BIRTHDAY: return color_escape(colors.birthday);
+        case EventType::REMINDER: return color_escape(colors.reminder);
         default: return GREEN;
     }
 }
 
-bool has_events(int month, int day) {
-    std::string key = std::to_string(month) + "-" + std::to_string(day);
-    return events.find(key) != events.end();
+std::string_view get_event_color(const Event& event) {
+    return get_type_color(event.type);
 }
 
-std::vector<Event> get_events(int month, int day) {
+// Returns the events for a day without copying them, or nullptr if there are none
+const std::vector<Event>* find_events(int month, int day) {
+    if (events.empty()) return nullptr;
     std::string key = std::to_string(month) + "-" + std::to_string(day);
     auto it = events.find(key);
-    return (it != events.end()) ? it->second : std::vector<Event>();
+    return (it != events.end() && !it->second.empty()) ? &it->second : nullptr;
 }
 
-std::string get_month_color(int month) {
-    switch (month) {
-        case 1: return colors.january;
-        case 2: return colors.february;
-        case 3: return colors.march;
-        case 4: return colors.april;
-        case 5: return colors.may;
-        case 6: return colors.june;
-        case 7: return colors.july;
-        case 8: return colors.august;
-        case 9: return colors.september;
-        case 10: return colors.october;
-        case 11: return colors.november;
-        case 12: return colors.december;
-        default: return "";
-    }
+std::string_view get_month_color(int month) {
+    if (month < 1 || month > 12) return "";
+    return color_escape(colors.months[month - 1]);
 }
 
 int weekday(int y, int m, int d, bool monday_first = false) {
@@ -491,256 +737,1182 @@ int days_in_month(int y, int m) {
     return md[m];
 }
 
+// Range covered by the density index; matches the years accepted on the command line
+constexpr int DENSITY_FIRST_YEAR = 1900;
+constexpr int DENSITY_LAST_YEAR = 2100;
+constexpr int EVENT_TYPE_COUNT = 3;
+
+// Days since 1970-01-01 in the proleptic Gregorian calendar
+constexpr long days_from_civil(int y, int m, int d) {
+    y -= m <= 2;
+    long era = (y >= 0 ? y : y - 399) / 400;
+    long yoe = y - era * 400;
+    long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Inverse of days_from_civil
+void civil_from_days(long z, int& y, int& m, int& d) {
+    z += 719468;
+    long era = (z >= 0 ? z : z - 146096) / 146097;
+    long doe = z - era * 146097;
+    long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long mp = (5 * doy + 2) / 153;
+    d = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    m = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    y = static_cast<int>(yoe + era * 400 + (m <= 2));
+}
+
+// Slot of a month/day in a leap year (0-365), so Feb 29 has its own slot
+int day_of_leap_year(int m, int d) {
+    static const int before[] = {0, 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335};
+    return std::min(before[m] + d - 1, 365);
+}
+
+using SpanCounts = std::array<uint16_t, EVENT_TYPE_COUNT>;
+
+// Number of spans of each type covering each day, built once from the span list
+struct SpanCoverage {
+    std::array<SpanCounts, 366> yearly{};  // Repeating spans, by day_of_leap_year()
+    std::vector<SpanCounts> dated;         // Dated spans, by day since DENSITY_FIRST_YEAR-01-01
+    long first_day = days_from_civil(DENSITY_FIRST_YEAR, 1, 1);
+    long last_day = days_from_civil(DENSITY_LAST_YEAR, 12, 31);
+};
+
+SpanCoverage span_coverage;
+
+// Paint every span into difference arrays and prefix-sum them into per-day
+// coverage, so lookups cost the same however many or long the spans are
+void build_span_coverage() {
+    if (spans.empty()) return;
+
+    std::array<std::array<int, 367>, EVENT_TYPE_COUNT> yearly_diff{};
+    std::array<std::vector<int>, EVENT_TYPE_COUNT> dated_diff;
+    size_t days = static_cast<size_t>(span_coverage.last_day - span_coverage.first_day + 1);
+
+    for (const EventSpan& span : spans) {
+        int t = static_cast<int>(span.type);
+        if (span.start_year == 0) {
+            int start = day_of_leap_year(span.start_month, span.start_day);
+            int end = day_of_leap_year(span.end_month, span.end_day);
+            if (start <= end) {
+                yearly_diff[t][start]++;
+                yearly_diff[t][end + 1]--;
+            } else {
+                // Wraps past New Year: paint to Dec 31, then from Jan 1
+                yearly_diff[t][start]++;
+                yearly_diff[t][366]--;
+                yearly_diff[t][0]++;
+                yearly_diff[t][end + 1]--;
+            }
+        } else {
+            long start = std::max(days_from_civil(span.start_year, span.start_month, span.start_day), span_coverage.first_day);
+            long end = std::min(days_from_civil(span.end_year, span.end_month, span.end_day), span_coverage.last_day);
+            if (start > end) continue;
+            if (dated_diff[t].empty()) dated_diff[t].assign(days + 1, 0);
+            dated_diff[t][start - span_coverage.first_day]++;
+            dated_diff[t][end - span_coverage.first_day + 1]--;
+        }
+    }
+
+    for (int t = 0; t < EVENT_TYPE_COUNT; ++t) {
+        int running = 0;
+        for (int slot = 0; slot < 366; ++slot) {
+            running += yearly_diff[t][slot];
+            span_coverage.yearly[slot][t] = static_cast<uint16_t>(running);
+        }
+        if (dated_diff[t].empty()) continue;
+        if (span_coverage.dated.empty()) span_coverage.dated.assign(days, SpanCounts{});
+        running = 0;
+        for (size_t i = 0; i < days; ++i) {
+            running += dated_diff[t][i];
+            span_coverage.dated[i][t] = static_cast<uint16_t>(running);
+        }
+    }
+}
+
+// Number of spans of each type covering a date
+SpanCounts spans_on(int y, int m, int d) {
+    SpanCounts counts = span_coverage.yearly[day_of_leap_year(m, d)];
+    if (!span_coverage.dated.empty()) {
+        long day = days_from_civil(y, m, d);
+        if (day >= span_coverage.first_day && day <= span_coverage.last_day) {
+            const SpanCounts& dated = span_coverage.dated[day - span_coverage.first_day];
+            for (int t = 0; t < EVENT_TYPE_COUNT; ++t) counts[t] += dated[t];
+        }
+    }
+    return counts;
+}
+
+// Color for a date covered by a span, holidays first; false if no span covers it
+bool find_span_color(int y, int m, int d, std::string_view& color) {
+    if (spans.empty()) return false;
+    SpanCounts counts = spans_on(y, m, d);
+    for (int t = 0; t < EVENT_TYPE_COUNT; ++t) {
+        if (counts[t] > 0) {
+            color = get_type_color(static_cast<EventType>(t));
+            return true;
+        }
+    }
+    return false;
+}
+
+// Per-type prefix sums of event counts over every day in the covered range.
+// prefix[type][weekend][i] counts events on the first i days, so any range
+// count is a difference of two entries.
+struct DensityIndex {
+    bool built = false;
+    long first_day = days_from_civil(DENSITY_FIRST_YEAR, 1, 1);
+    long last_day = days_from_civil(DENSITY_LAST_YEAR, 12, 31);
+    std::array<std::array<std::vector<uint32_t>, 2>, EVENT_TYPE_COUNT> prefix;
+    std::vector<uint32_t> total;  // All types and days, for density lookups
+};
+
+DensityIndex density;
+
+// Color days by event density instead of event type (--heatmap)
+bool show_heatmap = false;
+
+// Build the density index from the loaded events; called once after load_events()
+void build_density_index() {
+    // Event counts by month/day and type, so the day loop needs no map lookups
+    uint32_t per_date[13][32][EVENT_TYPE_COUNT] = {};
+    for (const auto& entry : events) {
+        for (const Event& event : entry.second) {
+            per_date[event.month][event.day][static_cast<int>(event.type)]++;
+        }
+    }
+
+    size_t days = static_cast<size_t>(density.last_day - density.first_day + 1);
+    for (auto& by_type : density.prefix) {
+        for (auto& sums : by_type) sums.assign(days + 1, 0);
+    }
+    density.total.assign(days + 1, 0);
+
+    int y = DENSITY_FIRST_YEAR, m = 1, d = 1;
+    int wday = weekday(y, m, d);  // 0 = Sunday
+    for (size_t i = 0; i < days; ++i) {
+        int weekend = (wday == 0 || wday == 6) ? 1 : 0;
+        uint32_t day_total = 0;
+        auto covered = spans_on(y, m, d);
+        for (int t = 0; t < EVENT_TYPE_COUNT; ++t) {
+            uint32_t count = per_date[m][d][t] + covered[t];
+            density.prefix[t][weekend][i + 1] = density.prefix[t][weekend][i] + count;
+            density.prefix[t][1 - weekend][i + 1] = density.prefix[t][1 - weekend][i];
+            day_total += count;
+        }
+        density.total[i + 1] = density.total[i] + day_total;
+
+        wday = (wday + 1) % 7;
+        if (++d > days_in_month(y, m)) {
+            d = 1;
+            if (++m > 12) { m = 1; ++y; }
+        }
+    }
+    density.built = true;
+}
+
+// Clip an inclusive day range to the index; returns false if nothing is left
+bool clip_to_index(long& from, long& to) {
+    from = std::max(from, density.first_day);
+    to = std::min(to, density.last_day);
+    return density.built && from <= to;
+}
+
+// Events of one type on workdays or weekends in [from, to]
+uint32_t count_events_between(long from, long to, EventType type, bool weekend) {
+    if (!clip_to_index(from, to)) return 0;
+    const auto& sums = density.prefix[static_cast<int>(type)][weekend ? 1 : 0];
+    return sums[to - density.first_day + 1] - sums[from - density.first_day];
+}
+
+// All events in [from, to]
+uint32_t count_events_between(long from, long to) {
+    if (!clip_to_index(from, to)) return 0;
+    return density.total[to - density.first_day + 1] - density.total[from - density.first_day];
+}
+
+// Heat ramp from one event per day up to four or more
+constexpr ColorIndex HEAT_COLORS[] = {
+    color_index("gold"), color_index("orange"), color_index("rust"), color_index("crimson")
+};
+
+// Heat color for a date, or an empty view when it has no events or the heatmap is off
+std::string_view heat_color(int y, int m, int d) {
+    if (!show_heatmap) return "";
+    long day = days_from_civil(y, m, d);
+    uint32_t count = count_events_between(day, day);
+    if (count == 0) return "";
+    return color_escape(HEAT_COLORS[std::min<uint32_t>(count, 4) - 1]);
+}
+
+// Parse YYYY-MM-DD or YYYY/MM/DD
+bool parse_full_date(const std::string& date_str, int& y, int& m, int& d) {
+    char sep1 = 0, sep2 = 0;
+    std::istringstream iss(date_str);
+    if (!(iss >> y >> sep1 >> m >> sep2 >> d) || iss.peek() != EOF) return false;
+    if (sep1 != sep2 || (sep1 != '-' && sep1 != '/')) return false;
+    return m >= 1 && m <= 12 && d >= 1 && d <= days_in_month(y, m);
+}
+
+std::string format_date(long day) {
+    int y, m, d;
+    civil_from_days(day, y, m, d);
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%04d-%02d-%02d", y, m, d);
+    return buf;
+}
+
+// Print event counts by type and workday/weekend for [from, to], then the busiest weeks
+int print_stats(const std::string& from_str, const std::string& to_str, bool monday_first = false) {
+    int fy, fm, fd, ty, tm, td;
+    if (!parse_full_date(from_str, fy, fm, fd) || !parse_full_date(to_str, ty, tm, td)) {
+        std::cerr << "Invalid date range: " << from_str << " " << to_str << " (expected YYYY-MM-DD)\n";
+        return 1;
+    }
+    long from = days_from_civil(fy, fm, fd);
+    long to = days_from_civil(ty, tm, td);
+    if (from > to) std::swap(from, to);
+    if (from < density.first_day || to > density.last_day) {
+        std::cerr << "Date range must be within " << DENSITY_FIRST_YEAR << "-" << DENSITY_LAST_YEAR << "\n";
+        return 1;
+    }
+
+    static const char* type_names[EVENT_TYPE_COUNT] = {"Holiday", "Birthday", "Reminder"};
+    std::cout << "Events from " << format_date(from) << " to " << format_date(to)
+              << " (" << (to - from + 1) << " days)\n\n";
+    std::cout << std::left << std::setw(10) << "" << std::right
+              << std::setw(9) << "Workday" << std::setw(9) << "Weekend" << std::setw(9) << "Total" << "\n";
+    uint32_t workday_sum = 0, weekend_sum = 0;
+    for (int t = 0; t < EVENT_TYPE_COUNT; ++t) {
+        uint32_t workday = count_events_between(from, to, static_cast<EventType>(t), false);
+        uint32_t weekend = count_events_between(from, to, static_cast<EventType>(t), true);
+        workday_sum += workday;
+        weekend_sum += weekend;
+        std::cout << std::left << std::setw(10) << type_names[t] << std::right
+                  << std::setw(9) << workday << std::setw(9) << weekend << std::setw(9) << workday + weekend << "\n";
+    }
+    std::cout << std::left << std::setw(10) << "Total" << std::right
+              << std::setw(9) << workday_sum << std::setw(9) << weekend_sum
+              << std::setw(9) << workday_sum + weekend_sum << "\n";
+
+    // Busiest weeks, each clipped to the requested range
+    std::vector<std::pair<uint32_t, long>> weeks;
+    int y, m, d;
+    civil_from_days(from, y, m, d);
+    for (long week_start = from - weekday(y, m, d, monday_first); week_start <= to; week_start += 7) {
+        // Label each week by its first day inside the range
+        long first = std::max(week_start, from);
+        uint32_t count = count_events_between(first, std::min(week_start + 6, to));
+        if (count > 0) weeks.emplace_back(count, first);
+    }
+    std::stable_sort(weeks.begin(), weeks.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    if (!weeks.empty()) {
+        std::cout << "\nBusiest weeks:\n";
+        for (size_t i = 0; i < weeks.size() && i < 5; ++i) {
+            std::cout << "  " << format_date(weeks[i].second) << "  " << weeks[i].first
+                      << (weeks[i].first == 1 ? " event\n" : " events\n");
+        }
+    }
+    return 0;
+}
+
+// Searchable event; a single-day event starts and ends on the same date
+struct SearchDoc {
+    uint32_t description_offset;  // Into SearchIndex::descriptions
+    uint32_t description_length;
+    EventType type;
+    int start_year;  // 0 for events that repeat every year
+    int start_month;
+    int start_day;
+    int end_year;
+    int end_month;
+    int end_day;
+};
+
+// Token inverted index over event descriptions. Everything is stored as
+// flat arrays of plain values, with strings packed into character pools
+// and referenced by offset, so each array can be written to a cache file
+// and read back byte for byte.
+struct SearchIndex {
+    std::vector<SearchDoc> docs;
+    std::string descriptions;               // All descriptions, back to back
+    std::string token_chars;                // Sorted unique tokens, back to back
+    std::vector<uint32_t> token_offsets;    // Token i is [token_offsets[i], token_offsets[i + 1])
+    std::vector<uint32_t> posting_offsets;  // Postings of token i are [posting_offsets[i], posting_offsets[i + 1])
+    std::vector<uint32_t> postings;         // Document ids, ascending for each token
+
+    size_t token_count() const { return posting_offsets.empty() ? 0 : posting_offsets.size() - 1; }
+
+    std::string_view token(size_t i) const {
+        return std::string_view(token_chars).substr(token_offsets[i], token_offsets[i + 1] - token_offsets[i]);
+    }
+
+    std::string_view description(const SearchDoc& doc) const {
+        return std::string_view(descriptions).substr(doc.description_offset, doc.description_length);
+    }
+};
+
+SearchIndex search_index;
+
+// Lower-cased runs of letters and digits; bytes >= 0x80 are kept so UTF-8 names stay whole
+std::vector<std::string> tokenize(std::string_view text) {
+    std::vector<std::string> tokens;
+    std::string token;
+    for (char ch : text) {
+        unsigned char c = static_cast<unsigned char>(ch);
+        if (std::isalnum(c) || c >= 0x80) {
+            token += static_cast<char>(std::tolower(c));
+        } else if (!token.empty()) {
+            tokens.push_back(std::move(token));
+            token.clear();
+        }
+    }
+    if (!token.empty()) tokens.push_back(std::move(token));
+    return tokens;
+}
+
+// Build the search index from the loaded events; called once after load_events()
+void build_search_index() {
+    SearchIndex& index = search_index;
+    auto add_doc = [&index](const std::string& description, EventType type, int start_year, int start_month,
+                            int start_day, int end_year, int end_month, int end_day) {
+        index.docs.push_back({static_cast<uint32_t>(index.descriptions.size()), static_cast<uint32_t>(description.size()),
+                              type, start_year, start_month, start_day, end_year, end_month, end_day});
+        index.descriptions += description;
+    };
+    for (const auto& entry : events) {
+        for (const Event& event : entry.second) {
+            add_doc(event.description, event.type, 0, event.month, event.day, 0, event.month, event.day);
+        }
+    }
+    for (const EventSpan& span : spans) {
+        add_doc(span.description, span.type, span.start_year, span.start_month, span.start_day,
+                span.end_year, span.end_month, span.end_day);
+    }
+
+    std::unordered_map<std::string, std::vector<uint32_t>> postings_by_token;
+    for (uint32_t id = 0; id < index.docs.size(); ++id) {
+        for (std::string& token : tokenize(index.description(index.docs[id]))) {
+            std::vector<uint32_t>& ids = postings_by_token[std::move(token)];
+            if (ids.empty() || ids.back() != id) ids.push_back(id);
+        }
+    }
+
+    std::vector<const std::string*> tokens;
+    tokens.reserve(postings_by_token.size());
+    for (const auto& entry : postings_by_token) tokens.push_back(&entry.first);
+    std::sort(tokens.begin(), tokens.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+
+    index.token_offsets.reserve(tokens.size() + 1);
+    index.posting_offsets.reserve(tokens.size() + 1);
+    index.token_offsets.push_back(0);
+    index.posting_offsets.push_back(0);
+    for (const std::string* token : tokens) {
+        const std::vector<uint32_t>& ids = postings_by_token[*token];
+        index.token_chars += *token;
+        index.postings.insert(index.postings.end(), ids.begin(), ids.end());
+        index.token_offsets.push_back(static_cast<uint32_t>(index.token_chars.size()));
+        index.posting_offsets.push_back(static_cast<uint32_t>(index.postings.size()));
+    }
+}
+
+// First index in [lo, hi) where pred turns false, for a pred that is true then false
+template <typename Pred>
+size_t partition_index(size_t lo, size_t hi, Pred pred) {
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (pred(mid)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Ids of events whose description has, for every word of the term, a word starting with it
+std::vector<uint32_t> search_events(const std::string& term) {
+    const SearchIndex& index = search_index;
+    std::vector<uint32_t> result;
+    std::vector<uint64_t> marks;  // Bitmap over document ids
+    auto marked = [&marks](uint32_t id) { return (marks[id >> 6] >> (id & 63)) & 1; };
+    bool first = true;
+    for (const std::string& prefix : tokenize(term)) {
+        // Tokens sharing the prefix are contiguous in the sorted token list;
+        // two binary searches find both ends
+        size_t t_lo = partition_index(0, index.token_count(), [&](size_t i) { return index.token(i) < prefix; });
+        size_t t_hi = partition_index(t_lo, index.token_count(), [&](size_t i) {
+            return index.token(i).compare(0, prefix.size(), prefix) == 0;
+        });
+        const uint32_t* ids_begin = index.postings.data() + index.posting_offsets[t_lo];
+        const uint32_t* ids_end = index.postings.data() + index.posting_offsets[t_hi];
+
+        if (t_hi - t_lo > 1) {
+            // Several tokens: union their postings in a bitmap, which also
+            // keeps the ids ascending without sorting them
+            marks.assign((index.docs.size() + 63) / 64, 0);
+            for (const uint32_t* it = ids_begin; it != ids_end; ++it) marks[*it >> 6] |= uint64_t(1) << (*it & 63);
+            if (first) {
+                for (size_t word = 0; word < marks.size(); ++word) {
+                    if (marks[word] == 0) continue;
+                    for (int bit = 0; bit < 64; ++bit) {
+                        if ((marks[word] >> bit) & 1) result.push_back(static_cast<uint32_t>(word * 64 + bit));
+                    }
+                }
+            } else {
+                result.erase(std::remove_if(result.begin(), result.end(), [&](uint32_t id) { return !marked(id); }),
+                             result.end());
+            }
+        } else if (first) {
+            // A single token's postings are used in place
+            result.assign(ids_begin, ids_end);
+        } else if (result.size() * 16 < static_cast<size_t>(ids_end - ids_begin)) {
+            // Few candidates left: look each one up in the long list
+            result.erase(std::remove_if(result.begin(), result.end(),
+                                        [&](uint32_t id) { return !std::binary_search(ids_begin, ids_end, id); }),
+                         result.end());
+        } else {
+            // Comparable sizes: mark the candidates in a bitmap and filter the new list
+            marks.assign((index.docs.size() + 63) / 64, 0);
+            for (uint32_t id : result) marks[id >> 6] |= uint64_t(1) << (id & 63);
+            std::vector<uint32_t> both;
+            for (const uint32_t* it = ids_begin; it != ids_end; ++it) {
+                if (marked(*it)) both.push_back(*it);
+            }
+            result = std::move(both);
+        }
+        first = false;
+        if (result.empty()) break;
+    }
+    return result;
+}
+
+bool is_leap_year(int y) {
+    return y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
+}
+
+// Start and end day numbers of the first occurrence that has not ended before
+// today; dated events that are over keep their only occurrence
+void next_occurrence(const SearchDoc& doc, long today, long& start, long& end) {
+    if (doc.start_year != 0) {
+        start = days_from_civil(doc.start_year, doc.start_month, doc.start_day);
+        end = days_from_civil(doc.end_year, doc.end_month, doc.end_day);
+        return;
+    }
+
+    int today_y, today_m, today_d;
+    civil_from_days(today, today_y, today_m, today_d);
+    bool wraps = doc.end_month * 100 + doc.end_day < doc.start_month * 100 + doc.start_day;
+    // Start a year back for spans running past New Year; Feb 29 may be up to 8 years away
+    for (int y = today_y - 1; y <= today_y + 8; ++y) {
+        if (doc.start_month == 2 && doc.start_day == 29 && !is_leap_year(y)) continue;
+        start = days_from_civil(y, doc.start_month, doc.start_day);
+        end = days_from_civil(wraps ? y + 1 : y, doc.end_month, doc.end_day);
+        if (end >= today) return;
+    }
+}
+
+// Days highlighted in the grid for --find
+struct FindHighlight {
+    bool active = false;
+    std::array<bool, 366> yearly{};  // By day_of_leap_year()
+    std::vector<bool> dated;         // By day since DENSITY_FIRST_YEAR-01-01
+};
+
+FindHighlight find_highlight;
+
+void highlight_matches(const std::vector<uint32_t>& ids) {
+    find_highlight.active = true;
+    long first_day = days_from_civil(DENSITY_FIRST_YEAR, 1, 1);
+    long last_day = days_from_civil(DENSITY_LAST_YEAR, 12, 31);
+    for (uint32_t id : ids) {
+        const SearchDoc& doc = search_index.docs[id];
+        if (doc.start_year == 0) {
+            int slot = day_of_leap_year(doc.start_month, doc.start_day);
+            int end = day_of_leap_year(doc.end_month, doc.end_day);
+            while (true) {
+                find_highlight.yearly[slot] = true;
+                if (slot == end) break;
+                slot = (slot + 1) % 366;
+            }
+        } else {
+            long start = std::max(days_from_civil(doc.start_year, doc.start_month, doc.start_day), first_day);
+            long end = std::min(days_from_civil(doc.end_year, doc.end_month, doc.end_day), last_day);
+            if (start > end) continue;
+            if (find_highlight.dated.empty()) find_highlight.dated.assign(last_day - first_day + 1, false);
+            for (long day = start; day <= end; ++day) find_highlight.dated[day - first_day] = true;
+        }
+    }
+}
+
+bool is_found_day(int y, int m, int d) {
+    if (!find_highlight.active) return false;
+    if (find_highlight.yearly[day_of_leap_year(m, d)]) return true;
+    if (find_highlight.dated.empty()) return false;
+    long day = days_from_civil(y, m, d) - days_from_civil(DENSITY_FIRST_YEAR, 1, 1);
+    return day >= 0 && day < static_cast<long>(find_highlight.dated.size()) && find_highlight.dated[day];
+}
+
+// List matching events by their next date on or after today (the real date,
+// not the month being shown); dated events that are over come last
+void print_find_results(const std::string& term, const std::vector<uint32_t>& ids, int today_y, int today_m, int today_d) {
+    long today = days_from_civil(today_y, today_m, today_d);
+    struct Match {
+        bool past;
+        long start;
+        long end;
+        uint32_t id;
+    };
+    std::vector<Match> matches;
+    matches.reserve(ids.size());
+    for (uint32_t id : ids) {
+        long start = 0, end = 0;
+        next_occurrence(search_index.docs[id], today, start, end);
+        matches.push_back({end < today, start, end, id});
+    }
+    std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) {
+        if (a.past != b.past) return !a.past;
+        if (a.start != b.start) return a.start < b.start;
+        return a.id < b.id;
+    });
+
+    std::cout << "\n";
+    if (matches.empty()) {
+        std::cout << "No events match \"" << term << "\"\n";
+        return;
+    }
+    for (const Match& match : matches) {
+        const SearchDoc& doc = search_index.docs[match.id];
+        std::cout << get_type_color(doc.type) << format_date(match.start);
+        if (match.end != match.start) std::cout << " - " << format_date(match.end);
+        std::cout << RESET << "  " << search_index.description(doc) << "\n";
+    }
+}
+
+// Widest possible week row: 7 cells of underline, color, 2 digits and reset, plus separators
+constexpr size_t WEEK_BUFFER_SIZE = 7 * (sizeof(UNDERLINE) + 20 + 2 + sizeof(RESET)) + 6;
+// Header: 20 columns of padded name plus the month color and reset
+constexpr size_t HEADER_BUFFER_SIZE = 20 + 20 + sizeof(RESET);
+// A month touches at most 6 week rows
+constexpr size_t MAX_WEEKS = 6;
+
+// Calendar views selectable from the command line or in interactive mode
+enum class ViewMode {
+    MONTH,
+    THREE,
+    YEAR,
+    TWELVE
+};
+
+// Grid geometry of a month. It does not depend on the config, so it can be
+// computed while the config is still loading.
+struct MonthLayout {
+    int year;
+    int month;
+    int start;  // Column of the 1st
+    int days;
+    int weeks;
+};
+
+MonthLayout compute_month_layout(int y, int m, bool monday_first = false) {
+    MonthLayout layout;
+    layout.year = y;
+    layout.month = m;
+    layout.start = weekday(y, m, 1, monday_first);
+    layout.days = days_in_month(y, m);
+    layout.weeks = (layout.start + layout.days - 1) / 7 + 1;
+    return layout;
+}
+
+// Layouts for every month a view shows, in display order
+// Year and month of a month index (year * 12 + month - 1), rounding the year
+// down so indexes before year 0 still give a month in 1-12
+void split_month_index(int index, int& y, int& m) {
+    y = index >= 0 ? index / 12 : -((11 - index) / 12);
+    m = index - y * 12 + 1;
+}
+
+std::vector<MonthLayout> plan_view(ViewMode view, int y, int m, bool monday_first = false) {
+    int first = y * 12 + (m - 1);
+    int count = 1;
+    if (view == ViewMode::THREE) {
+        first -= 1;
+        count = 3;
+    } else if (view == ViewMode::YEAR) {
+        first = y * 12;
+        count = 12;
+    } else if (view == ViewMode::TWELVE) {
+        count = 12;
+    }
+
+    std::vector<MonthLayout> layouts;
+    layouts.reserve(count);
+    for (int i = first; i < first + count; ++i) {
+        int layout_y, layout_m;
+        split_month_index(i, layout_y, layout_m);
+        layouts.push_back(compute_month_layout(layout_y, layout_m, monday_first));
+    }
+    return layouts;
+}
+
 // Structure to hold month data for horizontal printing
 struct MonthData {
     std::string header;
-    std::vector<std::string> weeks;
+    std::vector<std::string> weeks;  // Only the first week_count rows are in use
+    int week_count = 0;
     int year;
     int month;
 };
 
-MonthData get_month_data(int y, int m, int today_y, int today_m, int today_d, bool monday_first = false) {
+// Append a day number right-aligned in 2 columns without allocating
+inline void append_day_number(std::string& out, int day) {
+    out += day < 10 ? ' ' : static_cast<char>('0' + day / 10);
+    out += static_cast<char>('0' + day % 10);
+}
+
+// Append one colored day cell (2 columns, no separator). Every view renders
+// days through here so they color and pad the same way.
+void append_day_cell(std::string& out, int y, int m, int d, int wday, int today_y, int today_m, int today_d, bool monday_first) {
+    bool is_today = (y == today_y && m == today_m && d == today_d);
+    const std::vector<Event>* day_events = find_events(m, d);
+    std::string_view heat = heat_color(y, m, d);
+    std::string_view span_color;
+    
+    // Days matching --find are underlined on top of their color
+    if (is_found_day(y, m, d)) {
+        out += UNDERLINE;
+    }
+    
+    // Apply colors in priority order: today > heatmap > events > weekend
+    if (is_today) {
+        out += REV;
+    } else if (!heat.empty()) {
+        out += heat;
+    } else if (day_events) {
+        out += get_event_color(day_events->front());
+    } else if (find_span_color(y, m, d, span_color)) {
+        out += span_color;
+    } else if ((monday_first && wday == 6) || (!monday_first && wday == 0)) {
+        out += color_escape(colors.sunday_date);  // Sunday
+    } else if ((monday_first && wday == 5) || (!monday_first && wday == 6)) {
+        out += color_escape(colors.saturday_date); // Saturday
+    } else {
+        out += color_escape(colors.workday_date); // Workday
+    }
+    
+    append_day_number(out, d);
+    out += RESET;
+}
+
+// Fill month data in place so callers can reuse the string buffers between months
+void build_month_data(MonthData& data, const MonthLayout& layout, int today_y, int today_m, int today_d, bool monday_first = false) {
     static const char* names[] = {
         "Jan","Feb","Mar","Apr","May","Jun",
         "Jul","Aug","Sep","Oct","Nov","Dec"
     };
     
-    MonthData data;
+    int y = layout.year;
+    int m = layout.month;
     data.year = y;
     data.month = m;
     
     // Compact header format: "Jan 2024" (8 chars max)
-    std::string year_str = std::to_string(y);
-    std::string month_color = get_month_color(m);
-    std::string month_name = std::string(names[m - 1]) + " " + year_str;
+    std::string_view month_color = get_month_color(m);
+    char month_name[32];
+    int header_len = std::snprintf(month_name, sizeof(month_name), "%s %d", names[m - 1], y);
     
     // Calculate padding for plain text (without color codes)
-    int header_len = month_name.length();
-    if (header_len > 20) {
-        month_name = month_name.substr(0, 20);
-        header_len = 20;
-    }
+    if (header_len > 20) header_len = 20;
     int padding = (20 - header_len) / 2;
     
-    // Build header with color codes
-    data.header = std::string(padding, ' ') + month_color + month_name + RESET + std::string(20 - header_len - padding, ' ');
+    // Size every buffer for the largest month on first use, so rebuilding
+    // the same MonthData never allocates
+    if (data.weeks.size() < MAX_WEEKS) {
+        data.weeks.resize(MAX_WEEKS);
+        for (std::string& week : data.weeks) week.reserve(WEEK_BUFFER_SIZE);
+        data.header.reserve(HEADER_BUFFER_SIZE);
+    }
     
-    int start = weekday(y, m, 1, monday_first);
-    int dim = days_in_month(y, m);
+    // Build header with color codes
+    data.header.clear();
+    data.header.append(padding, ' ');
+    data.header += month_color;
+    data.header.append(month_name, header_len);
+    data.header += RESET;
+    data.header.append(20 - header_len - padding, ' ');
     
-    // Calculate total weeks needed
-    int total_weeks = (start + dim - 1) / 7 + 1;
+    int start = layout.start;
+    int dim = layout.days;
+    int total_weeks = layout.weeks;
+    data.week_count = total_weeks;
     
     for (int week = 0; week < total_weeks; ++week) {
-        std::string week_str = "";
+        std::string& week_str = data.weeks[week];
+        week_str.clear();
         
         for (int wday = 0; wday < 7; ++wday) {
             int day_num = week * 7 + wday - start + 1;
             
             if (day_num < 1 || day_num > dim) {
-                // Empty space - 2 chars + space
-                week_str += "  ";
-                if (wday < 6) week_str += " ";
+                week_str += "  ";  // Empty cell
             } else {
-                // Format the day
-                bool is_today = (y == today_y && m == today_m && day_num == today_d);
-                bool has_event = has_events(m, day_num);
-                
-                std::string day_str = "";
-                
-                // Apply colors in priority order: today > events > weekend
-                if (is_today) {
-                    day_str += REV;
-                } else if (has_event) {
-                    auto day_events = get_events(m, day_num);
-                    if (!day_events.empty()) {
-                        day_str += get_event_color(day_events[0]);
-                    }
-                } else if ((monday_first && wday == 6) || (!monday_first && wday == 0)) {
-                    day_str += colors.sunday_date;  // Sunday
-                } else if ((monday_first && wday == 5) || (!monday_first && wday == 6)) {
-                    day_str += colors.saturday_date; // Saturday
-                } else {
-                    day_str += colors.workday_date; // Workday
-                }
-                
-                // Format day with exactly 3 chars per day including space
-                if (day_num < 10) {
-                    day_str += " " + std::to_string(day_num);
-                } else {
-                    day_str += std::to_string(day_num);
-                }
-                
-                day_str += RESET;
-                week_str += day_str;
-                
-                // Add space after day except for last day of week
-                if (wday < 6) {
-                    week_str += " ";
-                }
+                append_day_cell(week_str, y, m, day_num, wday, today_y, today_m, today_d, monday_first);
+            }
+            
+            // Add space after day except for last day of week
+            if (wday < 6) {
+                week_str += ' ';
             }
         }
-        
-        data.weeks.push_back(week_str);
     }
-    
+}
+
+MonthData get_month_data(int y, int m, int today_y, int today_m, int today_d, bool monday_first = false) {
+    MonthData data;
+    build_month_data(data, compute_month_layout(y, m, monday_first), today_y, today_m, today_d, monday_first);
     return data;
 }
 
-void print_month_horizontal(const std::vector<MonthData>& months, bool monday_first = false) {
+void print_month_horizontal(const std::vector<MonthData>& months, bool monday_first = false, std::ostream& out = std::cout) {
     if (months.empty()) return;
 
     // Print headers - each month is 20 chars, 1 space between (20+1+20+1+20 = 62)
     for (size_t i = 0; i < months.size(); ++i) {
-        std::cout << months[i].header;
-        if (i < months.size() - 1) std::cout << " ";
+        out << months[i].header;
+        if (i < months.size() - 1) out << " ";
     }
-    std::cout << "\n";
+    out << "\n";
 
     // Print day headers - Su Mo Tu We Th Fr Sa = 20 chars exactly
     for (size_t i = 0; i < months.size(); ++i) {
         if (monday_first) {
-            std::cout << colors.workday_title << "Mo Tu We Th Fr " << RESET
-                      << colors.saturday_title << "Sa" << RESET << " "
-                      << colors.sunday_title << "Su" << RESET;
+            out << color_escape(colors.workday_title) << "Mo Tu We Th Fr " << RESET
+                      << color_escape(colors.saturday_title) << "Sa" << RESET << " "
+                      << color_escape(colors.sunday_title) << "Su" << RESET;
         } else {
-            std::cout << colors.sunday_title << "Su" << RESET << " "
-                      << colors.workday_title << "Mo Tu We Th Fr " << RESET
-                      << colors.saturday_title << "Sa" << RESET;
+            out << color_escape(colors.sunday_title) << "Su" << RESET << " "
+                      << color_escape(colors.workday_title) << "Mo Tu We Th Fr " << RESET
+                      << color_escape(colors.saturday_title) << "Sa" << RESET;
         }
-        if (i < months.size() - 1) std::cout << " ";
+        if (i < months.size() - 1) out << " ";
     }
-    std::cout << "\n";
+    out << "\n";
 
     // Find the maximum number of weeks
-    size_t max_weeks = 0;
+    int max_weeks = 0;
     for (const auto& month : months) {
-        max_weeks = std::max(max_weeks, month.weeks.size());
+        max_weeks = std::max(max_weeks, month.week_count);
     }
 
     // Print weeks - each week is exactly 20 chars
-    for (size_t week = 0; week < max_weeks; ++week) {
+    for (int week = 0; week < max_weeks; ++week) {
         for (size_t i = 0; i < months.size(); ++i) {
-            if (week < months[i].weeks.size()) {
-                std::cout << months[i].weeks[week];
+            if (week < months[i].week_count) {
+                out << months[i].weeks[week];
             } else {
-                std::cout << "                    "; // 20 spaces for empty weeks
+                out << "                    "; // 20 spaces for empty weeks
             }
-            if (i < months.size() - 1) std::cout << " ";
+            if (i < months.size() - 1) out << " ";
         }
-        std::cout << "\n";
+        out << "\n";
     }
 }
 
-void print_month_vertical(int y, int m, int today_y, int today_m, int today_d, bool monday_first = false) {
+void print_month_vertical(const MonthLayout& layout, int today_y, int today_m, int today_d, bool monday_first = false, std::ostream& out = std::cout) {
     static const char* names[] = {
         "January","February","March","April","May","June",
         "July","August","September","October","November","December"
     };
     
-    std::string month_color = get_month_color(m);
+    int y = layout.year;
+    int m = layout.month;
+    
+    std::string_view month_color = get_month_color(m);
     if (monday_first) {
-        std::cout << "     " << month_color << names[m - 1] << " " << y << RESET << "\n"
-                  << colors.workday_title << "Mo Tu We Th Fr " << RESET
-                  << colors.saturday_title << "Sa " << RESET
-                  << colors.sunday_title << "Su" << RESET << "\n";
+        out << "     " << month_color << names[m - 1] << " " << y << RESET << "\n"
+                  << color_escape(colors.workday_title) << "Mo Tu We Th Fr " << RESET
+                  << color_escape(colors.saturday_title) << "Sa " << RESET
+                  << color_escape(colors.sunday_title) << "Su" << RESET << "\n";
     } else {
-        std::cout << "     " << month_color << names[m - 1] << " " << y << RESET << "\n"
-                  << colors.sunday_title << "Su " << RESET
-                  << colors.workday_title << "Mo Tu We Th Fr " << RESET
-                  << colors.saturday_title << "Sa" << RESET << "\n";
+        out << "     " << month_color << names[m - 1] << " " << y << RESET << "\n"
+                  << color_escape(colors.sunday_title) << "Su " << RESET
+                  << color_escape(colors.workday_title) << "Mo Tu We Th Fr " << RESET
+                  << color_escape(colors.saturday_title) << "Sa" << RESET << "\n";
     }
     
-    int start = weekday(y, m, 1, monday_first);
-    int dim = days_in_month(y, m);
-    for (int i = 0; i < start; ++i) std::cout << "   ";
-    for (int d = 1; d <= dim; ++d) {
-        int wday = weekday(y, m, d, monday_first);
-        bool is_today = (y == today_y && m == today_m && d == today_d);
-        bool has_event = has_events(m, d);
-        
-        // Apply colors in priority order: today > events > weekend
-        if (is_today) {
-            std::cout << REV;
-        } else if (has_event) {
-            auto day_events = get_events(m, d);
-            if (!day_events.empty()) {
-                std::cout << get_event_color(day_events[0]);
-            }
-        } else if ((monday_first && wday == 6) || (!monday_first && wday == 0)) {
-            std::cout << colors.sunday_date;  // Sunday
-        } else if ((monday_first && wday == 5) || (!monday_first && wday == 6)) {
-            std::cout << colors.saturday_date; // Saturday
-        } else {
-            std::cout << colors.workday_date; // Workday
-        }
-        
-        if (d < 10) {
-            std::cout << " " << d << RESET << " ";
-        } else {
-            std::cout << d << RESET << " ";
-        }
-        if (wday == 6) std::cout << "\n";
+    // Each day is followed by a space, and Saturday (or Sunday) ends the line
+    std::string days;
+    days.reserve(layout.weeks * WEEK_BUFFER_SIZE);
+    days.append(layout.start * 3, ' ');
+    for (int d = 1; d <= layout.days; ++d) {
+        int wday = (layout.start + d - 1) % 7;
+        append_day_cell(days, y, m, d, wday, today_y, today_m, today_d, monday_first);
+        days += ' ';
+        if (wday == 6) days += '\n';
     }
-    std::cout << "\n";
+    days += '\n';
+    out << days;
 }
 
-void print_year(int year, int today_y, int today_m, int today_d, bool monday_first = false) {
+void print_month_rows(const std::vector<MonthLayout>& layouts, int today_y, int today_m, int today_d, bool monday_first = false, std::ostream& out = std::cout) {
+    if (layouts.empty()) return;
+
     // Center year in 80 columns
+    int year = layouts.front().year;
     std::string year_str = std::to_string(year);
     int padding = (80 - year_str.length()) / 2;
-    std::cout << std::string(padding, ' ') << year << "\n\n";
+    out << std::string(padding, ' ') << year << "\n\n";
     
-    for (int row = 0; row < 4; ++row) {
-        std::vector<MonthData> months;
-        for (int col = 0; col < 3; ++col) {
-            int month = row * 3 + col + 1;
-            if (month <= 12) {
-                months.push_back(get_month_data(year, month, today_y, today_m, today_d, monday_first));
-            }
+    // Rows are rebuilt in place so week buffers are reused after the first row
+    std::vector<MonthData> months(3);
+    for (size_t row = 0; row < layouts.size(); row += 3) {
+        months.resize(std::min<size_t>(3, layouts.size() - row));
+        for (size_t col = 0; col < months.size(); ++col) {
+            build_month_data(months[col], layouts[row + col], today_y, today_m, today_d, monday_first);
+        }
+        print_month_horizontal(months, monday_first, out);
+        out << "\n";
+    }
+}
+
+void print_events_legend(std::ostream& out = std::cout) {
+    out << "\nLegend:\n";
+#ifdef _WIN32
+    // Use asterisk for better compatibility in Visual Studio console
+    out << color_escape(colors.holiday) << "*" << RESET << " Holiday  ";
+    out << color_escape(colors.birthday) << "*" << RESET << " Birthday  ";
+    out << color_escape(colors.reminder) << "*" << RESET << " Reminder\n";
+#else
+    out << color_escape(colors.holiday) << "●" << RESET << " Holiday  ";
+    out << color_escape(colors.birthday) << "●" << RESET << " Birthday  ";
+    out << color_escape(colors.reminder) << "●" << RESET << " Reminder\n";
+#endif
+}
+
+// Legend for --heatmap, where days are colored by event count instead of type
+void print_heatmap_legend(std::ostream& out = std::cout) {
+    static const char* labels[] = {"1", "2", "3", "4+ events per day"};
+    out << "\nLegend:\n";
+    for (int i = 0; i < 4; ++i) {
+#ifdef _WIN32
+        out << color_escape(HEAT_COLORS[i]) << "*" << RESET << " " << labels[i];
+#else
+        out << color_escape(HEAT_COLORS[i]) << "●" << RESET << " " << labels[i];
+#endif
+        out << (i < 3 ? "  " : "\n");
+    }
+}
+
+void print_view(ViewMode view, const std::vector<MonthLayout>& layouts, int today_y, int today_m, int today_d, bool monday_first = false, std::ostream& out = std::cout) {
+    if (view == ViewMode::TWELVE || view == ViewMode::YEAR) {
+        print_month_rows(layouts, today_y, today_m, today_d, monday_first, out);
+    } else if (view == ViewMode::THREE) {
+        std::vector<MonthData> months(layouts.size());
+        for (size_t i = 0; i < layouts.size(); ++i) {
+            build_month_data(months[i], layouts[i], today_y, today_m, today_d, monday_first);
+        }
+        print_month_horizontal(months, monday_first, out);
+    } else {
+        print_month_vertical(layouts.front(), today_y, today_m, today_d, monday_first, out);
+    }
+
+    // Show legend if there are events
+    if (show_heatmap && !events.empty()) {
+        print_heatmap_legend(out);
+    } else if (!events.empty() || !spans.empty()) {
+        print_events_legend(out);
+    }
+}
+
+// A rendered screen in interactive mode
+struct PageKey {
+    ViewMode view;
+    int year;
+    int month;
+
+    bool operator<(const PageKey& other) const {
+        if (view != other.view) return view < other.view;
+        if (year != other.year) return year < other.year;
+        return month < other.month;
+    }
+    bool operator==(const PageKey& other) const {
+        return view == other.view && year == other.year && month == other.month;
+    }
+};
+
+// Year pages do not depend on the month, so they share one key per year
+PageKey make_page_key(ViewMode view, int y, int m) {
+    return {view, y, view == ViewMode::YEAR ? 1 : m};
+}
+
+// Keep a month index to the range interactive mode shows, years 1-9999
+// (weekday() needs a positive year)
+int clamp_page_index(int index) {
+    return std::max(1 * 12, std::min(index, 9999 * 12 + 11));
+}
+
+// Page a number of months away, stopping at the ends of the range
+PageKey shift_page(const PageKey& key, int months) {
+    int y, m;
+    split_month_index(clamp_page_index(key.year * 12 + (key.month - 1) + months), y, m);
+    return make_page_key(key.view, y, m);
+}
+
+// Small thread-safe LRU cache of rendered pages
+class PageCache {
+public:
+    explicit PageCache(size_t capacity) : capacity_(capacity) {}
+
+    bool get(const PageKey& key, std::string& page) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it == index_.end()) return false;
+        pages_.splice(pages_.begin(), pages_, it->second);
+        page = it->second->second;
+        return true;
+    }
+
+    bool contains(const PageKey& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return index_.count(key) != 0;
+    }
+
+    void put(const PageKey& key, std::string page) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            pages_.splice(pages_.begin(), pages_, it->second);
+            return;
         }
-        if (!months.empty()) {
-            print_month_horizontal(months, monday_first);
-            std::cout << "\n";
+        pages_.emplace_front(key, std::move(page));
+        index_[key] = pages_.begin();
+        if (pages_.size() > capacity_) {
+            index_.erase(pages_.back().first);
+            pages_.pop_back();
         }
     }
+
+private:
+    using PageList = std::list<std::pair<PageKey, std::string>>;
+
+    size_t capacity_;
+    std::mutex mutex_;
+    PageList pages_;
+    std::map<PageKey, PageList::iterator> index_;
+};
+
+// Settings that stay fixed for an interactive session
+struct InteractiveState {
+    int today_y;
+    int today_m;
+    int today_d;
+    bool monday_first;
+};
+
+std::string render_page(const PageKey& key, const InteractiveState& state) {
+    std::ostringstream out;
+    print_view(key.view, plan_view(key.view, key.year, key.month, state.monday_first),
+               state.today_y, state.today_m, state.today_d, state.monday_first, out);
+    return out.str();
 }
 
-void print_twelve_months(int start_year, int start_month, int today_y, int today_m, int today_d, bool monday_first = false) {
-    // Center year in 80 columns
-    std::string year_str = std::to_string(start_year);
-    int padding = (80 - year_str.length()) / 2;
-    std::cout << std::string(padding, ' ') << start_year << "\n\n";
-    
-    for (int row = 0; row < 4; ++row) {
-        std::vector<MonthData> months;
-        for (int col = 0; col < 3; ++col) {
-            int month_offset = row * 3 + col;
-            int current_month = start_month + month_offset;
-            int current_year = start_year + (current_month - 1) / 12;
-            int adjusted_month = ((current_month - 1) % 12) + 1;
-            
-            months.push_back(get_month_data(current_year, adjusted_month, today_y, today_m, today_d, monday_first));
+// Background thread that renders the pages one keypress away from the current one
+class PagePrefetcher {
+public:
+    PagePrefetcher(PageCache& cache, const InteractiveState& state)
+        : cache_(cache), state_(state), worker_(&PagePrefetcher::run, this) {}
+
+    ~PagePrefetcher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
         }
-        if (!months.empty()) {
-            print_month_horizontal(months, monday_first);
-            std::cout << "\n";
+        wake_.notify_one();
+        worker_.join();
+    }
+
+    void prefetch_around(const PageKey& key) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            center_ = key;
+            pending_ = true;
         }
+        wake_.notify_one();
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [this] { return stop_ || pending_; });
+            if (stop_) return;
+            PageKey center = center_;
+            pending_ = false;
+            lock.unlock();
+
+            // Nearest neighbours first: next/previous month, then next/previous year.
+            // At the ends of the range a shift lands back on the center and is skipped.
+            const int offsets[] = {1, -1, 12, -12};
+            for (int offset : offsets) {
+                PageKey key = shift_page(center, offset);
+                if (key == center || cache_.contains(key)) continue;
+                cache_.put(key, render_page(key, state_));
+                std::lock_guard<std::mutex> check(mutex_);
+                if (stop_ || pending_) break;  // The user moved on; restart around the new page
+            }
+
+            lock.lock();
+        }
+    }
+
+    PageCache& cache_;
+    InteractiveState state_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    PageKey center_ = {ViewMode::MONTH, 0, 1};
+    bool pending_ = false;
+    bool stop_ = false;
+    std::thread worker_;  // Declared last so it starts after the members it uses
+};
+
+enum class Key {
+    NONE,
+    LEFT,
+    RIGHT,
+    UP,
+    DOWN,
+    TODAY,
+    VIEW_MONTH,
+    VIEW_THREE,
+    VIEW_YEAR,
+    VIEW_TWELVE,
+    QUIT
+};
+
+Key key_from_char(int ch) {
+    switch (ch) {
+        case 'h': return Key::LEFT;
+        case 'l': return Key::RIGHT;
+        case 'k': return Key::UP;
+        case 'j': return Key::DOWN;
+        case 't': return Key::TODAY;
+        case '1': return Key::VIEW_MONTH;
+        case '3': return Key::VIEW_THREE;
+        case 'y': return Key::VIEW_YEAR;
+        case 'Y': return Key::VIEW_TWELVE;
+        case 'q': case 3: case 4: case 27: return Key::QUIT;  // q, Ctrl-C, Ctrl-D, Esc
+        default: return Key::NONE;
     }
 }
 
-void print_events_legend() {
-    std::cout << "\nLegend:\n";
 #ifdef _WIN32
-    // Use asterisk for better compatibility in Visual Studio console
-    std::cout << colors.holiday << "*" << RESET << " Holiday  ";
-    std::cout << colors.birthday << "*" << RESET << " Birthday  ";
-    std::cout << colors.reminder << "*" << RESET << " Reminder\n";
+Key read_key() {
+    int ch = _getch();
+    if (ch == 0 || ch == 224) {
+        switch (_getch()) {
+            case 75: return Key::LEFT;
+            case 77: return Key::RIGHT;
+            case 72: return Key::UP;
+            case 80: return Key::DOWN;
+            default: return Key::NONE;
+        }
+    }
+    return key_from_char(ch);
+}
 #else
-    std::cout << colors.holiday << "●" << RESET << " Holiday  ";
-    std::cout << colors.birthday << "●" << RESET << " Birthday  ";
-    std::cout << colors.reminder << "●" << RESET << " Reminder\n";
+// Puts the terminal in non-canonical, no-echo mode for the lifetime of the object.
+// Signal keys are turned off too, so Ctrl-C reaches read_key() as a quit key
+// and the terminal and screen are restored on the way out instead of being
+// left behind by SIGINT.
+class RawTerminal {
+public:
+    RawTerminal() {
+        active_ = tcgetattr(STDIN_FILENO, &saved_) == 0;
+        if (!active_) return;
+        termios raw = saved_;
+        raw.c_lflag &= ~(ICANON | ECHO | ISIG);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    }
+    ~RawTerminal() {
+        if (active_) tcsetattr(STDIN_FILENO, TCSANOW, &saved_);
+    }
+
+private:
+    termios saved_;
+    bool active_ = false;
+};
+
+Key read_key() {
+    char buf[8];
+    ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+    if (n <= 0) return Key::QUIT;
+    // Arrow keys arrive in one read as ESC [ A-D (or ESC O A-D); a lone ESC quits
+    if (buf[0] == 27 && n >= 3 && (buf[1] == '[' || buf[1] == 'O')) {
+        switch (buf[2]) {
+            case 'D': return Key::LEFT;
+            case 'C': return Key::RIGHT;
+            case 'A': return Key::UP;
+            case 'B': return Key::DOWN;
+            default: return Key::NONE;
+        }
+    }
+    if (buf[0] == 27 && n > 1) return Key::NONE;
+    return key_from_char(static_cast<unsigned char>(buf[0]));
+}
+#endif
+
+int run_interactive(ViewMode view, int y, int m, int today_y, int today_m, int today_d, bool monday_first) {
+#ifndef _WIN32
+    if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) {
+        std::cerr << "Interactive mode requires a terminal\n";
+        return 1;
+    }
+    RawTerminal raw_terminal;
 #endif
+    InteractiveState state = {today_y, today_m, today_d, monday_first};
+    PageCache cache(32);
+    PagePrefetcher prefetcher(cache, state);
+
+    // Switch to the alternate screen and hide the cursor
+    std::cout << "\x1b[?1049h\x1b[?25l";
+
+    // Start inside the range too; the command line accepts any year
+    split_month_index(clamp_page_index(y * 12 + (m - 1)), y, m);
+
+    std::string page;
+    while (true) {
+        PageKey key = make_page_key(view, y, m);
+        if (!cache.get(key, page)) {
+            page = render_page(key, state);
+            cache.put(key, page);
+        }
+        prefetcher.prefetch_around(key);
+
+        std::cout << "\x1b[H\x1b[2J" << page
+                  << "\n<-/-> h/l month  up/down k/j year  1/3/y/Y view  t today  q quit" << std::flush;
+
+        int month_index = y * 12 + (m - 1);
+        Key pressed = read_key();
+        if (pressed == Key::QUIT) break;
+        switch (pressed) {
+            case Key::LEFT: month_index -= 1; break;
+            case Key::RIGHT: month_index += 1; break;
+            case Key::UP: month_index -= 12; break;
+            case Key::DOWN: month_index += 12; break;
+            case Key::TODAY: month_index = today_y * 12 + (today_m - 1); break;
+            case Key::VIEW_MONTH: view = ViewMode::MONTH; break;
+            case Key::VIEW_THREE: view = ViewMode::THREE; break;
+            case Key::VIEW_YEAR: view = ViewMode::YEAR; break;
+            case Key::VIEW_TWELVE: view = ViewMode::TWELVE; break;
+            default: break;
+        }
+        split_month_index(clamp_page_index(month_index), y, m);
+    }
+
+    std::cout << "\x1b[?25h\x1b[?1049l" << std::flush;
+    return 0;
 }
 
 void print_help() {
@@ -751,6 +1923,10 @@ void print_help() {
     std::cout << "  -m, --monday          Monday as first day of week\n";
     std::cout << "  -y, --year            Display a calendar for the current year\n";
     std::cout << "  -Y, --twelve          Display the next twelve months\n";
+    std::cout << "  -i, --interactive     Browse months with arrow/hjkl keys\n";
+    std::cout << "  --stats FROM TO       Count events between two dates (YYYY-MM-DD)\n";
+    std::cout << "  --heatmap             Color days by number of events\n";
+    std::cout << "  --find TERM           List events matching TERM by next date and mark their days\n";
     std::cout << "  -h, --help            Display this help\n\n";
     std::cout << "Events are loaded from ~/.cal2/cal2.ini\n";
     std::cout << "Format: MM/DD Description (e.g., 12/25 Christmas)\n";
@@ -770,6 +1946,11 @@ int main(int argc, char* argv[]) {
     bool show_twelve = false;
     bool show_help = false;
     bool monday_first = false;
+    bool interactive = false;
+    bool show_stats = false;
+    std::string stats_from, stats_to;
+    bool show_find = false;
+    std::string find_term;
     
     // Parse command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -782,6 +1963,25 @@ int main(int argc, char* argv[]) {
             show_twelve = true;
         } else if (arg == "-m" || arg == "--monday") {
             monday_first = true;
+        } else if (arg == "--stats") {
+            if (i + 2 >= argc) {
+                std::cerr << "--stats requires FROM and TO dates (YYYY-MM-DD)\n";
+                return 1;
+            }
+            show_stats = true;
+            stats_from = argv[++i];
+            stats_to = argv[++i];
+        } else if (arg == "--find") {
+            if (i + 1 >= argc) {
+                std::cerr << "--find requires a search term\n";
+                return 1;
+            }
+            show_find = true;
+            find_term = argv[++i];
+        } else if (arg == "--heatmap") {
+            show_heatmap = true;
+        } else if (arg == "-i" || arg == "--interactive") {
+            interactive = true;
         } else if (arg == "-h" || arg == "--help") {
             show_help = true;
         } else if (arg[0] != '-') {
@@ -821,32 +2021,43 @@ int main(int argc, char* argv[]) {
     }
 #endif
 
-    // Load events from config file
-    load_events();
-
-    if (show_twelve) {
-        print_twelve_months(y, m, y, m, d, monday_first);
-    } else if (show_year) {
-        print_year(y, y, m, d, monday_first);
-    } else if (show3) {
-        int pm = m == 1 ? 12 : m - 1;
-        int py = m == 1 ? y - 1 : y;
-        int nm = m == 12 ? 1 : m + 1;
-        int ny = m == 12 ? y + 1 : y;
-        
-        std::vector<MonthData> months;
-        months.push_back(get_month_data(py, pm, y, m, d, monday_first));
-        months.push_back(get_month_data(y, m, y, m, d, monday_first));
-        months.push_back(get_month_data(ny, nm, y, m, d, monday_first));
-        
-        print_month_horizontal(months, monday_first);
-    } else {
-        print_month_vertical(y, m, y, m, d, monday_first);
+    ViewMode view = show_twelve ? ViewMode::TWELVE
+                  : show_year ? ViewMode::YEAR
+                  : show3 ? ViewMode::THREE
+                  : ViewMode::MONTH;
+
+    // Config discovery and parsing run on a helper thread while the grid
+    // geometry, which does not need the config, is laid out here
+    std::future<void> config_loaded = std::async(std::launch::async, [&] {
+        load_events();
+        build_span_coverage();
+        if (show_stats || show_heatmap) {
+            build_density_index();
+        }
+        if (show_find) {
+            build_search_index();
+        }
+    });
+    std::vector<MonthLayout> layouts = plan_view(view, y, m, monday_first);
+    config_loaded.get();
+
+    std::vector<uint32_t> found;
+    if (show_find) {
+        found = search_events(find_term);
+        highlight_matches(found);
     }
-    
-    // Show legend if there are events
-    if (!events.empty()) {
-        print_events_legend();
+
+    if (show_stats) {
+        return print_stats(stats_from, stats_to, monday_first);
+    }
+
+    if (interactive) {
+        return run_interactive(view, y, m, lt.tm_year + 1900, lt.tm_mon + 1, d, monday_first);
+    }
+
+    print_view(view, layouts, y, m, d, monday_first);
+    if (show_find) {
+        print_find_results(find_term, found, lt.tm_year + 1900, lt.tm_mon + 1, d);
     }
     
     return 0;
@@ -0,0 +1,116 @@
+// alloc_budget.cpp - allocation budgets for the cal2 render paths
+//
+// Builds cal2.cpp with a counting global operator new and fails when a view
+// allocates more than its budget. Run through CTest with HOME pointing at
+// tests/data so the sample events are loaded.
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static size_t allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    ++allocation_count;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#define main cal2_main
+#include "cal2.cpp"
+#undef main
+
+// Stream that drops everything, so only the renderer's own allocations count
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+static int failures = 0;
+
+static void check(const char* what, size_t allocations, size_t budget) {
+    bool ok = allocations <= budget;
+    std::printf("%-44s %4zu allocations (budget %zu)%s\n", what, allocations, budget, ok ? "" : "  FAILED");
+    if (!ok) ++failures;
+}
+
+template <typename F>
+static size_t count_allocations(F render) {
+    size_t before = allocation_count;
+    render();
+    return allocation_count - before;
+}
+
+int main() {
+    load_events();
+    build_span_coverage();
+    if (events.empty()) {
+        std::printf("No events loaded; run with HOME set to tests/data\n");
+        return 1;
+    }
+
+    NullBuffer null_buffer;
+    std::ostream out(&null_buffer);
+
+    for (bool monday_first : {false, true}) {
+        std::printf("%s first:\n", monday_first ? "Monday" : "Sunday");
+
+        // Day cells: once a MonthData has been built, rebuilding any month into it is free
+        MonthData data;
+        build_month_data(data, compute_month_layout(2024, 1, monday_first), 2024, 1, 15, monday_first);
+        check("  cells, every month 1900-2100 after warm-up", count_allocations([&] {
+            for (int y = 1900; y <= 2100; ++y) {
+                for (int m = 1; m <= 12; ++m) {
+                    build_month_data(data, compute_month_layout(y, m, monday_first), y, m, 15, monday_first);
+                }
+            }
+        }), 0);
+
+        // -y: rows after the first reuse the first row's buffers, so the whole
+        // year must cost exactly what its first row costs
+        std::vector<MonthLayout> year = plan_view(ViewMode::YEAR, 2024, 1, monday_first);
+        std::vector<MonthLayout> first_row(year.begin(), year.begin() + 3);
+        print_month_rows(year, 2024, 6, 15, monday_first, out);
+        size_t first_row_cost = count_allocations([&] {
+            print_month_rows(first_row, 2024, 6, 15, monday_first, out);
+        });
+        check("  -y rows 2-4 (beyond the first row)", count_allocations([&] {
+            print_month_rows(year, 2024, 6, 15, monday_first, out);
+        }) - first_row_cost, 0);
+
+        // Whole views, including planning the layouts. Budgets are the counts
+        // with libstdc++ plus a little headroom for other standard libraries.
+        struct ViewBudget {
+            const char* name;
+            ViewMode view;
+            size_t budget;
+        };
+        const ViewBudget budgets[] = {
+            {"  single month", ViewMode::MONTH, 4},
+            {"  -3", ViewMode::THREE, 32},
+            {"  -y", ViewMode::YEAR, 32},
+            {"  -Y", ViewMode::TWELVE, 32},
+        };
+        for (const ViewBudget& view : budgets) {
+            print_view(view.view, plan_view(view.view, 2024, 7, monday_first), 2024, 7, 15, monday_first, out);
+            check(view.name, count_allocations([&] {
+                print_view(view.view, plan_view(view.view, 2024, 7, monday_first), 2024, 7, 15, monday_first, out);
+            }), view.budget);
+        }
+    }
+
+    if (failures) {
+        std::printf("%d allocation budget(s) exceeded\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,140 @@
+// golden_frames.cpp - rendered calendar frames against a golden manifest
+//
+// Renders every view (single month, -3, -y, -Y) with both week starts for
+// every month from 1900 to 2100 and compares each frame with the manifest,
+// which holds one FNV-1a hash per view, week start and year. The manifests
+// in tests/golden were produced by the original renderer, so any change to
+// the output shows up here. The 90th percentile frame time of each view
+// must also stay within that view's budget; the slowest frames are left out
+// because a preempted render can take 100x the usual time.
+//
+// Usage: golden_frames MANIFEST            check the current renderer
+//        golden_frames MANIFEST --generate  rewrite MANIFEST from it
+//
+// Frames are rendered as "cal2 [-3|-y|-Y] [-m] M Y" would on the 15th of
+// the month (June 15 for -y), with the config found through HOME.
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+#define main cal2_main
+#include "cal2.cpp"
+#undef main
+
+struct ViewSpec {
+    const char* name;
+    const char* flag;
+    ViewMode view;
+    int months_per_year;  // Frames per year; -y shows the whole year once
+    long budget_us;       // For the p90 frame; about 10x its time in an unoptimized build
+};
+
+const ViewSpec VIEWS[] = {
+    {"month", "", ViewMode::MONTH, 12, 200},
+    {"three", "-3 ", ViewMode::THREE, 12, 600},
+    {"year", "-y ", ViewMode::YEAR, 1, 2500},
+    {"twelve", "-Y ", ViewMode::TWELVE, 12, 2500},
+};
+
+std::string render_frame(const ViewSpec& spec, int y, int m, bool monday_first) {
+    int today_m = spec.view == ViewMode::YEAR ? 6 : m;
+    std::ostringstream out;
+    print_view(spec.view, plan_view(spec.view, y, m, monday_first), y, today_m, 15, monday_first, out);
+    return out.str();
+}
+
+long time_frame(const ViewSpec& spec, int y, int m, bool monday_first, std::string& frame) {
+    auto start = std::chrono::steady_clock::now();
+    frame = render_frame(spec, y, m, monday_first);
+    return static_cast<long>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+uint64_t fnv1a(uint64_t hash, const std::string& bytes) {
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: golden_frames MANIFEST [--generate]\n");
+        return 2;
+    }
+    std::string manifest_path = argv[1];
+    bool generate = argc > 2 && std::string(argv[2]) == "--generate";
+
+    load_events();
+    build_span_coverage();
+
+    // view week-start year -> hash
+    std::map<std::string, std::string> expected;
+    if (!generate) {
+        std::ifstream manifest(manifest_path);
+        if (!manifest.is_open()) {
+            std::fprintf(stderr, "Could not open manifest: %s\n", manifest_path.c_str());
+            return 2;
+        }
+        std::string line;
+        while (std::getline(manifest, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            size_t split = line.rfind(' ');
+            expected[line.substr(0, split)] = line.substr(split + 1);
+        }
+    }
+
+    std::ostringstream generated;
+    generated << "# view week-start year fnv1a64-of-its-frames\n";
+    int mismatches = 0;
+    int frames = 0;
+    for (const ViewSpec& spec : VIEWS) {
+        std::vector<long> times_us;
+        for (bool monday_first : {false, true}) {
+            for (int y = DENSITY_FIRST_YEAR; y <= DENSITY_LAST_YEAR; ++y) {
+                uint64_t hash = 14695981039346656037ull;
+                for (int m = 1; m <= spec.months_per_year; ++m) {
+                    std::string frame;
+                    times_us.push_back(time_frame(spec, y, m, monday_first, frame));
+                    hash = fnv1a(hash, frame);
+                    ++frames;
+                }
+
+                char key[64], digest[17];
+                std::snprintf(key, sizeof(key), "%s %s %d", spec.name, monday_first ? "monday" : "sunday", y);
+                std::snprintf(digest, sizeof(digest), "%016" PRIx64, hash);
+                generated << key << " " << digest << "\n";
+                if (generate) continue;
+
+                auto it = expected.find(key);
+                if (it == expected.end() || it->second != digest) {
+                    if (++mismatches <= 10) {
+                        std::printf("Mismatch: %s (reproduce with cal2 %s%s%s%d)\n", key, spec.flag,
+                                    monday_first ? "-m " : "", spec.months_per_year > 1 ? "<month> " : "", y);
+                    }
+                }
+            }
+        }
+        std::sort(times_us.begin(), times_us.end());
+        long median_us = times_us[times_us.size() / 2];
+        long p90_us = times_us[times_us.size() * 9 / 10];
+        bool slow = p90_us > spec.budget_us;
+        std::printf("%-7s median %5ld us, p90 %5ld us (budget %ld us), slowest %6ld us%s\n", spec.name, median_us,
+                    p90_us, spec.budget_us, times_us.back(), slow ? "  FAILED" : "");
+        if (slow) ++mismatches;
+    }
+
+    if (generate) {
+        std::ofstream manifest(manifest_path);
+        manifest << generated.str();
+        std::printf("Wrote %d frames to %s\n", frames, manifest_path.c_str());
+        return manifest ? 0 : 1;
+    }
+    if (mismatches) {
+        std::printf("%d check(s) failed over %d frames\n", mismatches, frames);
+        return 1;
+    }
+    std::printf("%d frames match %s\n", frames, manifest_path.c_str());
+    return 0;
+}